@@ -0,0 +1,27 @@
+#ifndef EXPORTADOR_H
+#define EXPORTADOR_H
+
+#include <stdbool.h> // Para usar bool
+#include "lista_dupla.h" // Inclui as definições de Produto e Lista
+
+// --- Constantes ---
+#define EXPORTADOR_TAM_BUFFER (256 * 1024) // Tamanho de cada buffer de saída
+#define EXPORTADOR_N_BUFFERS 4             // Buffers enviados juntos em cada writev
+#define EXPORTADOR_MAX_REGISTRO 512        // Maior tamanho possível de um registro formatado
+
+// --- Tipos ---
+typedef enum FormatoExportacao {
+    FORMATO_CSV,     // Cabeçalho + uma linha por produto, nome sempre entre aspas
+    FORMATO_JSONL,   // Um objeto JSON por linha (JSON Lines)
+    FORMATO_BINARIO  // Registros Produto de tamanho fixo, o mesmo formato do modo arquivo
+} FormatoExportacao;
+
+// Filtro opcional: retorna true para exportar o produto.
+typedef bool (*FiltroProduto)(const Produto *p, void *contexto);
+
+// --- Protótipos das Funções de Exportação ---
+bool Exportador_formatoPorNome(const char *nome, FormatoExportacao *formato);
+long Lista_exportar(Lista *lista, int fd, FormatoExportacao formato, FiltroProduto filtro, void *contexto);
+long Lista_exportarArquivo(Lista *lista, const char *caminho, FormatoExportacao formato, FiltroProduto filtro, void *contexto);
+
+#endif // EXPORTADOR_H
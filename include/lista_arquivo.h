@@ -0,0 +1,41 @@
+#ifndef LISTA_ARQUIVO_H
+#define LISTA_ARQUIVO_H
+
+#include <stdio.h>   // Para FILE
+#include <stddef.h>  // Para size_t
+#include <stdbool.h> // Para usar bool
+#include "lista_dupla.h" // Inclui as definições de Produto, Node e Lista
+
+// --- Constantes ---
+#define REGISTROS_POR_PAGINA 64              // Produtos carregados do disco de uma só vez
+#define ORCAMENTO_PADRAO_BYTES (1024 * 1024) // Memória padrão do cache de páginas (1 MiB)
+
+// --- Estruturas ---
+
+// Uma página do arquivo mantida em memória. As páginas formam uma lista
+// duplamente ligada em ordem de uso (LRU), da mais recente para a menos recente.
+typedef struct Pagina {
+    long indice;      // Número da página no arquivo
+    int nRegistros;   // Quantidade de registros válidos nesta página
+    bool modificada;  // true se a página precisa ser gravada de volta no disco
+    struct Pagina *maisRecente;
+    struct Pagina *menosRecente;
+    Node nos[REGISTROS_POR_PAGINA];
+} Pagina;
+
+// Estado do modo "arquivo": a Lista é apoiada por um arquivo de registros
+// Produto de tamanho fixo, carregados sob demanda.
+typedef struct ListaArquivo {
+    FILE *arquivo;
+    long nPaginas;       // Páginas atualmente em memória
+    long nPaginasMax;    // Limite de páginas em memória (derivado do orçamento)
+    long indiceAtual;    // Posição do nó 'current' no arquivo (-1 se nenhum)
+    Pagina *maisRecente; // Início da lista LRU
+    Pagina *menosRecente; // Fim da lista LRU (primeira candidata a sair do cache)
+} ListaArquivo;
+
+// --- Protótipos das Funções do Modo Arquivo ---
+bool Lista_abrirArquivo(Lista *lista, const char *caminho, size_t orcamento_bytes);
+bool ListaArquivo_salvar(Lista *lista);
+
+#endif // LISTA_ARQUIVO_H
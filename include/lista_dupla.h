@@ -15,6 +15,7 @@ typedef struct Node {
     Produto produto;
     struct Node *prev;
     struct Node *next;
+    struct VersaoProduto *versoes; // Valores antigos ainda vistos por snapshots (ver snapshot.h)
 } Node;
 
 typedef struct Lista {
@@ -22,6 +23,13 @@ typedef struct Lista {
   Node *first;
   Node *last;
   Node *current;
+  Node *bloco;   // Bloco contíguo criado por Lista_compactar (NULL se não houver)
+  int nBloco;    // Número de nós alocados no bloco
+  struct ListaArquivo *arquivo; // Modo arquivo (ver lista_arquivo.h); NULL se a lista estiver em memória
+  unsigned long epoca;          // Incrementada a cada snapshot aberto
+  struct Snapshot *snapshots;   // Snapshots abertos (ver snapshot.h)
+  Node *removidos;              // Nós removidos que ainda fazem parte de snapshots abertos
+  long nVersoes;                // Total de versões antigas guardadas para snapshots
 } Lista;
 
 // --- Protótipos das Funções de Manipulação da Lista (CRUD) ---
@@ -38,4 +46,8 @@ void Lista_goLast(Lista *lista);
 Produto *Lista_getCurrent(Lista *lista);
 Node *Lista_getNodeById(Lista *lista, int id_produto);
 
+// --- Protótipos das Funções de Localidade de Memória ---
+double Lista_distanciaMedia(Lista *lista);
+bool Lista_compactar(Lista *lista, double *distancia_antes, double *distancia_depois);
+
 #endif // LISTA_DUPLA_H
\ No newline at end of file
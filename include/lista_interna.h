@@ -0,0 +1,26 @@
+#ifndef LISTA_INTERNA_H
+#define LISTA_INTERNA_H
+
+// Funções compartilhadas entre os módulos da lista (lista_dupla.c, lista_arquivo.c,
+// snapshot.c e exportador.c). Não fazem parte da API: não inclua este arquivo
+// fora desses módulos, pois elas não validam o estado da lista.
+
+#include <stdbool.h> // Para usar bool
+#include "lista_dupla.h" // Inclui as definições de Produto, Node e Lista
+
+// --- lista_dupla.c ---
+void Lista_liberaNo(Lista *lista, Node *node);
+
+// --- lista_arquivo.c (só com lista->arquivo != NULL) ---
+void ListaArquivo_fechar(Lista *lista);
+bool ListaArquivo_irPara(Lista *lista, long indice);
+bool ListaArquivo_inserir(Lista *lista, Produto *data);
+Node *ListaArquivo_getNodeById(Lista *lista, int id_produto);
+void ListaArquivo_marcarModificado(Lista *lista, Node *node);
+
+// --- snapshot.c ---
+bool Snapshot_preservarVersao(Lista *lista, Node *node);
+void Snapshot_liberarVersoes(Lista *lista, Node *node);
+void Snapshot_destruirTodos(Lista *lista);
+
+#endif // LISTA_INTERNA_H
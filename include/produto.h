@@ -17,4 +17,12 @@
 Produto criarProduto(int id, const char* nome, float preco, int quantidade);
 void exibir_detalhes_produto(Produto *p);
 
+/**
+ * @brief Copia um produto como registro de tamanho fixo, com bytes de preenchimento zerados.
+ * Use antes de gravar um Produto em disco, para não vazar lixo da memória para o arquivo.
+ * @param destino Registro a ser preenchido.
+ * @param origem Produto a ser copiado.
+ */
+void copiarRegistroProduto(Produto *destino, const Produto *origem);
+
 #endif // PRODUTO_H
@@ -0,0 +1,39 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h> // Para usar bool
+#include "lista_dupla.h" // Inclui as definições de Produto, Node e Lista
+
+// --- Estruturas ---
+
+// Valor antigo de um produto, guardado quando ele é alterado ou removido
+// enquanto há snapshots abertos. As versões de um nó formam uma lista da
+// mais nova para a mais antiga (épocas decrescentes).
+typedef struct VersaoProduto {
+    Produto produto;             // Valor do produto antes da alteração
+    unsigned long epoca;         // Época da alteração: visível para snapshots com época <= este valor
+    struct VersaoProduto *anterior; // Versão mais antiga
+} VersaoProduto;
+
+// Visão da lista congelada no momento da abertura. Percorra-a com
+// Snapshot_goFirst/Snapshot_next/Snapshot_prev/Snapshot_getCurrent.
+typedef struct Snapshot {
+    Lista *lista;
+    unsigned long epoca;      // Época da lista na abertura do snapshot
+    Node **nos;               // Nós da lista na abertura, em ordem
+    int nElementos;
+    int posicao;              // Cursor do snapshot (-1 se vazio)
+    struct Snapshot *proximo; // Próximo snapshot aberto na mesma lista
+} Snapshot;
+
+// --- Protótipos das Funções de Snapshot ---
+bool Lista_abrirSnapshot(Lista *lista, Snapshot *snapshot);
+void Lista_fecharSnapshot(Snapshot *snapshot);
+int Snapshot_getSize(Snapshot *snapshot);
+bool Snapshot_next(Snapshot *snapshot);
+bool Snapshot_prev(Snapshot *snapshot);
+void Snapshot_goFirst(Snapshot *snapshot);
+void Snapshot_goLast(Snapshot *snapshot);
+const Produto *Snapshot_getCurrent(Snapshot *snapshot);
+
+#endif // SNAPSHOT_H
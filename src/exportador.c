@@ -0,0 +1,382 @@
+// src/exportador.c
+#include <stdio.h>     // Para fprintf
+#include <stdlib.h>    // Para malloc, free
+#include <string.h>    // Para memcpy, strcmp, strnlen
+#include <stdbool.h>   // Para tipo bool
+#include <errno.h>     // Para errno, EINTR
+#include <fcntl.h>     // Para open
+#include <unistd.h>    // Para close
+#include <sys/uio.h>   // Para writev, struct iovec
+#include "exportador.h"    // Inclui as definições do exportador
+#include "lista_arquivo.h" // Para percorrer listas no modo arquivo
+#include "snapshot.h"      // Para exportar uma visão consistente da lista em memória
+#include "produto.h"       // Para copiarRegistroProduto
+#include "lista_interna.h" // Para ListaArquivo_irPara
+
+// Estado de uma exportação: os registros são formatados diretamente em
+// buffers grandes, que são entregues ao sistema juntos em um único writev.
+typedef struct Exportador {
+    int fd;
+    FormatoExportacao formato;
+    int bufferAtual;                        // Buffer sendo preenchido
+    size_t usado;                           // Bytes usados no buffer atual
+    size_t tamanhos[EXPORTADOR_N_BUFFERS];  // Bytes dos buffers já preenchidos
+    bool erro;
+    char (*buffers)[EXPORTADOR_TAM_BUFFER];
+} Exportador;
+
+/**
+ * @brief Grava os primeiros 'n' buffers preenchidos com writev, tratando gravações parciais.
+ * @param exp Ponteiro para o estado da exportação.
+ * @param n Quantidade de buffers a gravar.
+ * @return true se tudo foi gravado, false em caso de erro.
+ */
+static bool Exportador_gravar(Exportador *exp, int n) {
+    struct iovec iov[EXPORTADOR_N_BUFFERS];
+    int nIov = 0;
+    for (int i = 0; i < n; i++) {
+        if (exp->tamanhos[i] > 0) {
+            iov[nIov].iov_base = exp->buffers[i];
+            iov[nIov].iov_len = exp->tamanhos[i];
+            nIov++;
+        }
+    }
+
+    struct iovec *pendente = iov;
+    while (nIov > 0) {
+        ssize_t gravado = writev(exp->fd, pendente, nIov);
+        if (gravado < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Erro: Falha ao gravar a exportacao");
+            return false;
+        }
+        // Descarta os buffers já gravados e ajusta o primeiro parcialmente gravado
+        while (nIov > 0 && (size_t)gravado >= pendente->iov_len) {
+            gravado -= (ssize_t)pendente->iov_len;
+            pendente++;
+            nIov--;
+        }
+        if (nIov > 0) {
+            pendente->iov_base = (char *)pendente->iov_base + gravado;
+            pendente->iov_len -= (size_t)gravado;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Garante espaço para um registro formatado no buffer atual.
+ * Quando o buffer atual está cheio, passa para o próximo; quando todos estão cheios,
+ * grava-os de uma só vez.
+ * @param exp Ponteiro para o estado da exportação.
+ * @return Ponteiro para a posição livre no buffer, ou NULL em caso de erro.
+ */
+static char *Exportador_reservar(Exportador *exp) {
+    if (EXPORTADOR_TAM_BUFFER - exp->usado < EXPORTADOR_MAX_REGISTRO) {
+        exp->tamanhos[exp->bufferAtual] = exp->usado;
+        exp->bufferAtual++;
+        exp->usado = 0;
+        if (exp->bufferAtual == EXPORTADOR_N_BUFFERS) {
+            if (!Exportador_gravar(exp, EXPORTADOR_N_BUFFERS)) {
+                exp->erro = true;
+                return NULL;
+            }
+            exp->bufferAtual = 0;
+        }
+    }
+    return exp->buffers[exp->bufferAtual] + exp->usado;
+}
+
+/**
+ * @brief Escreve um inteiro em decimal.
+ * @param p Posição de escrita.
+ * @param valor O inteiro a ser escrito.
+ * @return A posição logo após o último caractere escrito.
+ */
+static char *Exportador_escreverInt(char *p, long long valor) {
+    char tmp[24];
+    int n = 0;
+    unsigned long long v = (valor < 0) ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    if (valor < 0) {
+        *p++ = '-';
+    }
+    while (n > 0) {
+        *p++ = tmp[--n];
+    }
+    return p;
+}
+
+/**
+ * @brief Escreve um preço com duas casas decimais (ex: 120.50).
+ * Valores não finitos ou fora do alcance de long long são escritos como 'invalido'.
+ * @param p Posição de escrita.
+ * @param preco O preço a ser escrito.
+ * @param invalido Texto usado quando o preço não pode ser representado.
+ * @return A posição logo após o último caractere escrito.
+ */
+static char *Exportador_escreverPreco(char *p, float preco, const char *invalido) {
+    double v = preco;
+    if (!(v > -9.0e16 && v < 9.0e16)) { // Também captura NaN
+        size_t n = strlen(invalido);
+        memcpy(p, invalido, n);
+        return p + n;
+    }
+    if (v < 0) {
+        *p++ = '-';
+        v = -v;
+    }
+    long long centavos = (long long)(v * 100.0 + 0.5);
+    p = Exportador_escreverInt(p, centavos / 100);
+    *p++ = '.';
+    *p++ = (char)('0' + (centavos / 10) % 10);
+    *p++ = (char)('0' + centavos % 10);
+    return p;
+}
+
+/**
+ * @brief Escreve o nome como campo CSV entre aspas, duplicando aspas internas.
+ * @param p Posição de escrita.
+ * @param nome O nome do produto.
+ * @param tamanho_max Tamanho do campo nome (o texto pode não ter terminação nula).
+ * @return A posição logo após o último caractere escrito.
+ */
+static char *Exportador_escreverCsvTexto(char *p, const char *nome, size_t tamanho_max) {
+    size_t n = strnlen(nome, tamanho_max);
+    *p++ = '"';
+    for (size_t i = 0; i < n; i++) {
+        if (nome[i] == '"') {
+            *p++ = '"';
+        }
+        *p++ = nome[i];
+    }
+    *p++ = '"';
+    return p;
+}
+
+/**
+ * @brief Escreve o nome como string JSON, escapando aspas, barras e caracteres de controle.
+ * @param p Posição de escrita.
+ * @param nome O nome do produto.
+ * @param tamanho_max Tamanho do campo nome (o texto pode não ter terminação nula).
+ * @return A posição logo após o último caractere escrito.
+ */
+static char *Exportador_escreverJsonTexto(char *p, const char *nome, size_t tamanho_max) {
+    static const char hex[] = "0123456789abcdef";
+    size_t n = strnlen(nome, tamanho_max);
+    *p++ = '"';
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)nome[i];
+        if (c == '"' || c == '\\') {
+            *p++ = '\\';
+            *p++ = (char)c;
+        } else if (c < 0x20) {
+            memcpy(p, "\\u00", 4);
+            p += 4;
+            *p++ = hex[c >> 4];
+            *p++ = hex[c & 0xf];
+        } else {
+            *p++ = (char)c;
+        }
+    }
+    *p++ = '"';
+    return p;
+}
+
+/**
+ * @brief Formata um produto no buffer atual, conforme o formato da exportação.
+ * @param exp Ponteiro para o estado da exportação.
+ * @param produto O produto a ser formatado.
+ * @return true se o produto foi formatado, false em caso de erro de gravação.
+ */
+static bool Exportador_registro(Exportador *exp, const Produto *produto) {
+    char *inicio = Exportador_reservar(exp);
+    if (inicio == NULL) {
+        return false;
+    }
+
+    char *p = inicio;
+    switch (exp->formato) {
+        case FORMATO_CSV:
+            p = Exportador_escreverInt(p, produto->id);
+            *p++ = ',';
+            p = Exportador_escreverCsvTexto(p, produto->nome, sizeof(produto->nome));
+            *p++ = ',';
+            p = Exportador_escreverPreco(p, produto->preco, "");
+            *p++ = ',';
+            p = Exportador_escreverInt(p, produto->quantidade);
+            *p++ = '\n';
+            break;
+        case FORMATO_JSONL:
+            memcpy(p, "{\"id\":", 6);
+            p = Exportador_escreverInt(p + 6, produto->id);
+            memcpy(p, ",\"nome\":", 8);
+            p = Exportador_escreverJsonTexto(p + 8, produto->nome, sizeof(produto->nome));
+            memcpy(p, ",\"preco\":", 9);
+            p = Exportador_escreverPreco(p + 9, produto->preco, "null");
+            memcpy(p, ",\"quantidade\":", 14);
+            p = Exportador_escreverInt(p + 14, produto->quantidade);
+            *p++ = '}';
+            *p++ = '\n';
+            break;
+        case FORMATO_BINARIO: {
+            // Copia campo a campo para não levar bytes de preenchimento não inicializados
+            Produto registro;
+            copiarRegistroProduto(&registro, produto);
+            memcpy(p, &registro, sizeof(Produto));
+            p += sizeof(Produto);
+            break;
+        }
+    }
+    exp->usado += (size_t)(p - inicio);
+    return true;
+}
+
+/**
+ * @brief Converte um nome de formato ("csv", "jsonl" ou "bin") no valor correspondente.
+ * @param nome Nome do formato.
+ * @param formato Recebe o formato, se o nome for reconhecido.
+ * @return true se o nome foi reconhecido, false caso contrário.
+ */
+bool Exportador_formatoPorNome(const char *nome, FormatoExportacao *formato) {
+    if (nome == NULL || formato == NULL) {
+        return false;
+    }
+    if (strcmp(nome, "csv") == 0) {
+        *formato = FORMATO_CSV;
+    } else if (strcmp(nome, "jsonl") == 0) {
+        *formato = FORMATO_JSONL;
+    } else if (strcmp(nome, "bin") == 0) {
+        *formato = FORMATO_BINARIO;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Exporta os produtos da lista, na ordem da lista, para um descritor de arquivo.
+ * Os registros são formatados sem printf em buffers grandes, gravados com writev,
+ * o que permite exportar para arquivos ou pipes (ex: STDOUT_FILENO).
+ * Em memória, se houver filtro, a exportação percorre um snapshot: o filtro pode alterar
+ * ou remover produtos sem afetar o que está sendo exportado. No modo arquivo, o 'current' da lista é preservado.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param fd Descritor de arquivo aberto para escrita.
+ * @param formato Formato de saída (CSV, JSON Lines ou binário).
+ * @param filtro Função que decide quais produtos exportar, ou NULL para exportar todos.
+ * @param contexto Ponteiro repassado ao filtro.
+ * @return O número de produtos exportados, ou -1 em caso de erro.
+ */
+long Lista_exportar(Lista *lista, int fd, FormatoExportacao formato, FiltroProduto filtro, void *contexto) {
+    if (lista == NULL || fd < 0) {
+        fprintf(stderr, "Erro: Ponteiro de lista nulo ou descritor invalido em Lista_exportar.\n");
+        return -1;
+    }
+
+    Exportador exp;
+    exp.fd = fd;
+    exp.formato = formato;
+    exp.bufferAtual = 0;
+    exp.usado = 0;
+    exp.erro = false;
+    exp.buffers = malloc(sizeof(*exp.buffers) * EXPORTADOR_N_BUFFERS);
+    if (exp.buffers == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para os buffers de exportacao.\n");
+        return -1;
+    }
+
+    if (formato == FORMATO_CSV) {
+        static const char cabecalho[] = "id,nome,preco,quantidade\n";
+        memcpy(exp.buffers[0], cabecalho, sizeof(cabecalho) - 1);
+        exp.usado = sizeof(cabecalho) - 1;
+    }
+
+    long exportados = 0;
+    if (lista->arquivo == NULL && filtro == NULL) {
+        // Sem filtro nada altera a lista durante a exportação: dispensa o snapshot
+        for (Node *temp = lista->first; temp != NULL && !exp.erro; temp = temp->next) {
+            if (Exportador_registro(&exp, &temp->produto)) {
+                exportados++;
+            }
+        }
+    } else if (lista->arquivo == NULL) {
+        Snapshot snapshot;
+        if (!Lista_abrirSnapshot(lista, &snapshot)) {
+            free(exp.buffers);
+            return -1;
+        }
+        for (int i = 0; i < Snapshot_getSize(&snapshot) && !exp.erro; i++, Snapshot_next(&snapshot)) {
+            // Copia o valor do snapshot: se o filtro alterar este produto, o ponteiro
+            // devolvido por Snapshot_getCurrent passaria a mostrar o valor novo
+            Produto produto = *Snapshot_getCurrent(&snapshot);
+            if (filtro(&produto, contexto)) {
+                if (Exportador_registro(&exp, &produto)) {
+                    exportados++;
+                }
+            }
+        }
+        Lista_fecharSnapshot(&snapshot);
+    } else if (lista->nElementos > 0) {
+        // No modo arquivo os nós só existem enquanto sua página está no cache,
+        // então a lista é percorrida por posição, e o cursor é restaurado no final
+        long indiceSalvo = lista->arquivo->indiceAtual;
+        for (long i = 0; i < lista->nElementos && !exp.erro; i++) {
+            if (!ListaArquivo_irPara(lista, i)) {
+                exp.erro = true; // Falha de leitura: a exportação ficaria incompleta
+                break;
+            }
+            Produto *produto = Lista_getCurrent(lista);
+            if (filtro == NULL || filtro(produto, contexto)) {
+                if (Exportador_registro(&exp, produto)) {
+                    exportados++;
+                }
+            }
+        }
+        if (indiceSalvo >= 0) {
+            ListaArquivo_irPara(lista, indiceSalvo);
+        } else {
+            // O cursor ainda não tinha sido posicionado (logo após Lista_abrirArquivo)
+            lista->arquivo->indiceAtual = -1;
+            lista->current = NULL;
+        }
+    }
+
+    if (!exp.erro) {
+        exp.tamanhos[exp.bufferAtual] = exp.usado;
+        exp.erro = !Exportador_gravar(&exp, exp.bufferAtual + 1);
+    }
+    free(exp.buffers);
+    return exp.erro ? -1 : exportados;
+}
+
+/**
+ * @brief Exporta os produtos da lista para um arquivo, criando-o ou substituindo-o.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param caminho Caminho do arquivo de saída.
+ * @param formato Formato de saída (CSV, JSON Lines ou binário).
+ * @param filtro Função que decide quais produtos exportar, ou NULL para exportar todos.
+ * @param contexto Ponteiro repassado ao filtro.
+ * @return O número de produtos exportados, ou -1 em caso de erro.
+ */
+long Lista_exportarArquivo(Lista *lista, const char *caminho, FormatoExportacao formato, FiltroProduto filtro, void *contexto) {
+    if (caminho == NULL) {
+        fprintf(stderr, "Erro: Caminho nulo em Lista_exportarArquivo.\n");
+        return -1;
+    }
+
+    int fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Erro: Nao foi possivel criar o arquivo '%s'.\n", caminho);
+        return -1;
+    }
+    long exportados = Lista_exportar(lista, fd, formato, filtro, contexto);
+    if (close(fd) != 0) {
+        exportados = -1;
+    }
+    return exportados;
+}
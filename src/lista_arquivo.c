@@ -0,0 +1,387 @@
+// src/lista_arquivo.c
+#include <stdio.h>   // Para FILE, fopen, fread, fwrite, fseek
+#include <stdlib.h>  // Para malloc, free
+#include <stdint.h>  // Para uintptr_t
+#include <stdbool.h> // Para tipo bool
+#include "lista_arquivo.h" // Inclui as definições do modo arquivo
+#include "produto.h"       // Para copiarRegistroProduto
+#include "lista_interna.h" // Funções compartilhadas entre os módulos da lista
+
+/**
+ * @brief Grava uma página modificada de volta no arquivo.
+ * @param arq Ponteiro para o estado do modo arquivo.
+ * @param pagina Ponteiro para a página a ser gravada.
+ * @return true se a gravação foi bem-sucedida (ou desnecessária), false caso contrário.
+ */
+static bool ListaArquivo_gravarPagina(ListaArquivo *arq, Pagina *pagina) {
+    if (!pagina->modificada) {
+        return true;
+    }
+
+    Produto registros[REGISTROS_POR_PAGINA];
+    for (int i = 0; i < pagina->nRegistros; i++) {
+        copiarRegistroProduto(&registros[i], &pagina->nos[i].produto);
+    }
+
+    long offset = pagina->indice * REGISTROS_POR_PAGINA * (long)sizeof(Produto);
+    if (fseek(arq->arquivo, offset, SEEK_SET) != 0 ||
+        fwrite(registros, sizeof(Produto), (size_t)pagina->nRegistros, arq->arquivo) != (size_t)pagina->nRegistros) {
+        fprintf(stderr, "Erro: Falha ao gravar a pagina %ld no arquivo.\n", pagina->indice);
+        return false;
+    }
+    pagina->modificada = false;
+    return true;
+}
+
+/**
+ * @brief Retira uma página da lista LRU, sem liberá-la.
+ * @param arq Ponteiro para o estado do modo arquivo.
+ * @param pagina Ponteiro para a página a ser desligada.
+ */
+static void ListaArquivo_desligarPagina(ListaArquivo *arq, Pagina *pagina) {
+    if (pagina->maisRecente == NULL) {
+        arq->maisRecente = pagina->menosRecente;
+    } else {
+        pagina->maisRecente->menosRecente = pagina->menosRecente;
+    }
+    if (pagina->menosRecente == NULL) {
+        arq->menosRecente = pagina->maisRecente;
+    } else {
+        pagina->menosRecente->maisRecente = pagina->maisRecente;
+    }
+    pagina->maisRecente = NULL;
+    pagina->menosRecente = NULL;
+}
+
+/**
+ * @brief Coloca uma página no início da lista LRU (mais recentemente usada).
+ * @param arq Ponteiro para o estado do modo arquivo.
+ * @param pagina Ponteiro para a página (já desligada da lista LRU).
+ */
+static void ListaArquivo_ligarNoInicio(ListaArquivo *arq, Pagina *pagina) {
+    pagina->maisRecente = NULL;
+    pagina->menosRecente = arq->maisRecente;
+    if (arq->maisRecente != NULL) {
+        arq->maisRecente->maisRecente = pagina;
+    } else {
+        arq->menosRecente = pagina;
+    }
+    arq->maisRecente = pagina;
+}
+
+/**
+ * @brief Escolhe uma página para sair do cache, da menos para a mais recente.
+ * A página que contém o nó 'current' nunca é escolhida, pois lista->current aponta para ela.
+ * @param arq Ponteiro para o estado do modo arquivo.
+ * @return Ponteiro para a página escolhida, ou NULL se nenhuma puder sair.
+ */
+static Pagina *ListaArquivo_escolherVitima(ListaArquivo *arq) {
+    long paginaAtual = (arq->indiceAtual >= 0) ? arq->indiceAtual / REGISTROS_POR_PAGINA : -1;
+    Pagina *pagina = arq->menosRecente;
+    while (pagina != NULL && pagina->indice == paginaAtual) {
+        pagina = pagina->maisRecente;
+    }
+    return pagina;
+}
+
+/**
+ * @brief Retorna a página de número 'indice', carregando-a do disco se necessário.
+ * Páginas além do fim do arquivo são criadas vazias (usado ao inserir).
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ * @param indice Número da página.
+ * @return Ponteiro para a página em memória, ou NULL em caso de erro.
+ */
+static Pagina *ListaArquivo_getPagina(Lista *lista, long indice) {
+    ListaArquivo *arq = lista->arquivo;
+
+    // Procura no cache; o número de páginas é pequeno e limitado pelo orçamento
+    for (Pagina *pagina = arq->maisRecente; pagina != NULL; pagina = pagina->menosRecente) {
+        if (pagina->indice == indice) {
+            if (pagina != arq->maisRecente) {
+                ListaArquivo_desligarPagina(arq, pagina);
+                ListaArquivo_ligarNoInicio(arq, pagina);
+            }
+            return pagina;
+        }
+    }
+
+    // Não está no cache: reaproveita a página menos usada ou aloca uma nova
+    Pagina *pagina;
+    if (arq->nPaginas >= arq->nPaginasMax && (pagina = ListaArquivo_escolherVitima(arq)) != NULL) {
+        if (!ListaArquivo_gravarPagina(arq, pagina)) {
+            return NULL;
+        }
+        ListaArquivo_desligarPagina(arq, pagina);
+    } else {
+        pagina = (Pagina *)malloc(sizeof(Pagina));
+        if (pagina == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação de memória para a pagina do cache.\n");
+            return NULL;
+        }
+        arq->nPaginas++;
+    }
+
+    Produto registros[REGISTROS_POR_PAGINA];
+    long primeiro = indice * REGISTROS_POR_PAGINA;
+    long restantes = lista->nElementos - primeiro;
+    int nRegistros = (int)(restantes < 0 ? 0 : (restantes > REGISTROS_POR_PAGINA ? REGISTROS_POR_PAGINA : restantes));
+
+    if (nRegistros > 0 &&
+        (fseek(arq->arquivo, primeiro * (long)sizeof(Produto), SEEK_SET) != 0 ||
+         fread(registros, sizeof(Produto), (size_t)nRegistros, arq->arquivo) != (size_t)nRegistros)) {
+        fprintf(stderr, "Erro: Falha ao ler a pagina %ld do arquivo.\n", indice);
+        free(pagina);
+        arq->nPaginas--;
+        return NULL;
+    }
+
+    pagina->indice = indice;
+    pagina->nRegistros = nRegistros;
+    pagina->modificada = false;
+    for (int i = 0; i < nRegistros; i++) {
+        pagina->nos[i].produto = registros[i];
+        // A navegação no modo arquivo é feita por posição, não por ponteiros
+        pagina->nos[i].prev = NULL;
+        pagina->nos[i].next = NULL;
+        pagina->nos[i].versoes = NULL;
+    }
+    ListaArquivo_ligarNoInicio(arq, pagina);
+    return pagina;
+}
+
+/**
+ * @brief Retorna o nó na posição 'indice' do arquivo, carregando sua página se necessário.
+ * O ponteiro retornado só é válido até o próximo acesso a outra página.
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ * @param indice Posição do produto no arquivo (0-baseado).
+ * @return Ponteiro para o nó, ou NULL se a posição for inválida ou houver erro.
+ */
+static Node *ListaArquivo_getNo(Lista *lista, long indice) {
+    if (indice < 0 || indice >= lista->nElementos) {
+        return NULL;
+    }
+    Pagina *pagina = ListaArquivo_getPagina(lista, indice / REGISTROS_POR_PAGINA);
+    if (pagina == NULL) {
+        return NULL;
+    }
+    return &pagina->nos[indice % REGISTROS_POR_PAGINA];
+}
+
+/**
+ * @brief Coloca a lista no modo arquivo, apoiada por um arquivo de registros Produto.
+ * Nenhum produto é lido na abertura: o número de elementos vem do tamanho do arquivo
+ * e as páginas são carregadas sob demanda por Lista_next, Lista_prev, Lista_getNodeById etc.
+ * Se o arquivo não existir, ele é criado vazio.
+ * No modo arquivo, first e last ficam NULL; percorra a lista com Lista_goFirst/Lista_next.
+ * @param lista Ponteiro para uma Lista recém-criada (vazia).
+ * @param caminho Caminho do arquivo de produtos.
+ * @param orcamento_bytes Memória máxima usada pelo cache de páginas (mínimo de duas páginas).
+ * @return true se o arquivo foi aberto com sucesso, false caso contrário.
+ */
+bool Lista_abrirArquivo(Lista *lista, const char *caminho, size_t orcamento_bytes) {
+    if (lista == NULL || caminho == NULL) {
+        fprintf(stderr, "Erro: Ponteiro de lista ou caminho nulos em Lista_abrirArquivo.\n");
+        return false;
+    }
+    if (lista->nElementos != 0 || lista->arquivo != NULL) {
+        fprintf(stderr, "Erro: Lista_abrirArquivo requer uma lista vazia.\n");
+        return false;
+    }
+    if (lista->snapshots != NULL || lista->removidos != NULL) {
+        // Lista_destroi no modo arquivo não fecharia os snapshots nem liberaria os nós pendentes
+        fprintf(stderr, "Erro: Lista_abrirArquivo nao pode ser usada com snapshots abertos.\n");
+        return false;
+    }
+
+    FILE *arquivo = fopen(caminho, "r+b");
+    if (arquivo == NULL) {
+        arquivo = fopen(caminho, "w+b"); // Cria o arquivo se ele não existir
+    }
+    if (arquivo == NULL) {
+        fprintf(stderr, "Erro: Nao foi possivel abrir o arquivo '%s'.\n", caminho);
+        return false;
+    }
+
+    long tamanho;
+    if (fseek(arquivo, 0, SEEK_END) != 0 || (tamanho = ftell(arquivo)) < 0) {
+        fprintf(stderr, "Erro: Nao foi possivel obter o tamanho do arquivo '%s'.\n", caminho);
+        fclose(arquivo);
+        return false;
+    }
+    if (tamanho % (long)sizeof(Produto) != 0) {
+        fprintf(stderr, "Erro: O arquivo '%s' nao contem registros de Produto validos.\n", caminho);
+        fclose(arquivo);
+        return false;
+    }
+
+    ListaArquivo *arq = (ListaArquivo *)malloc(sizeof(ListaArquivo));
+    if (arq == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o modo arquivo.\n");
+        fclose(arquivo);
+        return false;
+    }
+    arq->arquivo = arquivo;
+    arq->nPaginas = 0;
+    arq->nPaginasMax = (long)(orcamento_bytes / sizeof(Pagina));
+    if (arq->nPaginasMax < 2) {
+        arq->nPaginasMax = 2; // Uma página fixa para 'current' e outra para os demais acessos
+    }
+    arq->indiceAtual = -1;
+    arq->maisRecente = NULL;
+    arq->menosRecente = NULL;
+
+    // Uma lista compactada e depois esvaziada ainda guarda o bloco (sem nós em uso)
+    free(lista->bloco);
+    lista->bloco = NULL;
+    lista->nBloco = 0;
+
+    lista->arquivo = arq;
+    lista->nElementos = (int)(tamanho / (long)sizeof(Produto));
+    lista->first = NULL;
+    lista->last = NULL;
+    lista->current = NULL;
+    return true;
+}
+
+/**
+ * @brief Grava no disco todas as páginas modificadas do cache.
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ * @return true se todas as páginas foram gravadas, false caso contrário.
+ */
+bool ListaArquivo_salvar(Lista *lista) {
+    if (lista == NULL || lista->arquivo == NULL) {
+        fprintf(stderr, "Erro: Lista nula ou fora do modo arquivo em ListaArquivo_salvar.\n");
+        return false;
+    }
+
+    bool ok = true;
+    for (Pagina *pagina = lista->arquivo->maisRecente; pagina != NULL; pagina = pagina->menosRecente) {
+        if (!ListaArquivo_gravarPagina(lista->arquivo, pagina)) {
+            ok = false;
+        }
+    }
+    if (fflush(lista->arquivo->arquivo) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+/**
+ * @brief Grava as páginas modificadas, libera o cache e fecha o arquivo.
+ * Chamada por Lista_destroi; a lista volta ao modo em memória, vazia.
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ */
+void ListaArquivo_fechar(Lista *lista) {
+    if (lista == NULL || lista->arquivo == NULL) {
+        return;
+    }
+
+    if (!ListaArquivo_salvar(lista)) {
+        fprintf(stderr, "Erro: Alteracoes do catalogo podem ter sido perdidas ao fechar o arquivo.\n");
+    }
+    Pagina *pagina = lista->arquivo->maisRecente;
+    while (pagina != NULL) {
+        Pagina *proxima = pagina->menosRecente;
+        free(pagina);
+        pagina = proxima;
+    }
+    if (fclose(lista->arquivo->arquivo) != 0) {
+        perror("Erro: Falha ao fechar o arquivo do catalogo");
+    }
+    free(lista->arquivo);
+    lista->arquivo = NULL;
+    lista->current = NULL;
+    lista->nElementos = 0;
+}
+
+/**
+ * @brief Move o 'current' para a posição 'indice' do arquivo.
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ * @param indice Nova posição do 'current' (0-baseado).
+ * @return true se o 'current' foi movido, false se a posição for inválida ou houver erro.
+ */
+bool ListaArquivo_irPara(Lista *lista, long indice) {
+    if (indice < 0 || indice >= lista->nElementos) {
+        return false;
+    }
+    // Atualiza indiceAtual antes de carregar para que a nova página não seja
+    // confundida com a do 'current' antigo na escolha da vítima
+    long indiceAnterior = lista->arquivo->indiceAtual;
+    lista->arquivo->indiceAtual = indice;
+    Node *node = ListaArquivo_getNo(lista, indice);
+    if (node == NULL) {
+        // A página do 'current' antigo pode ter saído do cache: recarrega-a
+        lista->arquivo->indiceAtual = indiceAnterior;
+        lista->current = ListaArquivo_getNo(lista, indiceAnterior);
+        return false;
+    }
+    lista->current = node;
+    return true;
+}
+
+/**
+ * @brief Insere um produto no final do arquivo, através do cache de páginas.
+ * O novo produto passa a ser o 'current', como em Lista_inserir.
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ * @param data Ponteiro para os dados do Produto a serem inseridos.
+ * @return true se a inserção foi bem-sucedida, false caso contrário.
+ */
+bool ListaArquivo_inserir(Lista *lista, Produto *data) {
+    long indice = lista->nElementos;
+    Pagina *pagina = ListaArquivo_getPagina(lista, indice / REGISTROS_POR_PAGINA);
+    if (pagina == NULL) {
+        return false;
+    }
+
+    Node *node = &pagina->nos[indice % REGISTROS_POR_PAGINA];
+    copiarRegistroProduto(&node->produto, data);
+    node->prev = NULL;
+    node->next = NULL;
+    node->versoes = NULL;
+    pagina->nRegistros++;
+    pagina->modificada = true;
+
+    lista->nElementos++;
+    lista->arquivo->indiceAtual = indice;
+    lista->current = node;
+    return true;
+}
+
+/**
+ * @brief Busca um produto pelo ID percorrendo o arquivo página por página.
+ * O ponteiro retornado só é válido até o próximo acesso a outra página.
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ * @param id_produto O ID do produto a ser buscado.
+ * @return Ponteiro para o Nó encontrado, ou NULL se não for encontrado.
+ */
+Node *ListaArquivo_getNodeById(Lista *lista, int id_produto) {
+    long nPaginasArquivo = (lista->nElementos + REGISTROS_POR_PAGINA - 1) / REGISTROS_POR_PAGINA;
+    for (long p = 0; p < nPaginasArquivo; p++) {
+        Pagina *pagina = ListaArquivo_getPagina(lista, p);
+        if (pagina == NULL) {
+            return NULL;
+        }
+        for (int i = 0; i < pagina->nRegistros; i++) {
+            if (pagina->nos[i].produto.id == id_produto) {
+                return &pagina->nos[i];
+            }
+        }
+    }
+    return NULL; // Não encontrado
+}
+
+/**
+ * @brief Marca como modificada a página que contém o nó, para que seja gravada de volta.
+ * @param lista Ponteiro para a estrutura Lista em modo arquivo.
+ * @param node Ponteiro para um nó obtido do cache (ex: via Lista_getNodeById).
+ */
+void ListaArquivo_marcarModificado(Lista *lista, Node *node) {
+    for (Pagina *pagina = lista->arquivo->maisRecente; pagina != NULL; pagina = pagina->menosRecente) {
+        uintptr_t inicio = (uintptr_t)pagina->nos;
+        uintptr_t fim = (uintptr_t)(pagina->nos + REGISTROS_POR_PAGINA);
+        if ((uintptr_t)node >= inicio && (uintptr_t)node < fim) {
+            pagina->modificada = true;
+            return;
+        }
+    }
+}
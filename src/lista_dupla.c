@@ -3,7 +3,43 @@
 #include <stdlib.h>  // Para malloc, free
 #include <string.h>  // Para strcpy, strncpy
 #include <stdbool.h> // Para tipo bool
+#include <stdint.h>  // Para uintptr_t
 #include "lista_dupla.h" // Inclui as definições de structs e protótipos
+#include "lista_arquivo.h" // Para o modo arquivo (lista apoiada em disco)
+#include "snapshot.h"      // Para preservar versões vistas por snapshots abertos
+#include "lista_interna.h" // Funções compartilhadas entre os módulos da lista
+
+#ifdef __GLIBC__
+#include <malloc.h>  // Para malloc_trim (devolve memória livre ao sistema)
+#endif
+
+/**
+ * @brief Verifica se um nó pertence ao bloco contíguo criado por Lista_compactar.
+ * Nós dentro do bloco não podem ser liberados individualmente com free().
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param node Ponteiro para o nó a ser verificado.
+ * @return true se o nó está dentro do bloco, false caso contrário.
+ */
+static bool Lista_noNoBloco(Lista *lista, Node *node) {
+    if (lista->bloco == NULL) {
+        return false;
+    }
+    uintptr_t inicio = (uintptr_t)lista->bloco;
+    uintptr_t fim = (uintptr_t)(lista->bloco + lista->nBloco);
+    return (uintptr_t)node >= inicio && (uintptr_t)node < fim;
+}
+
+/**
+ * @brief Libera um nó, a menos que ele faça parte do bloco contíguo.
+ * O espaço de nós removidos do bloco só é recuperado na próxima compactação.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param node Ponteiro para o nó a ser liberado.
+ */
+void Lista_liberaNo(Lista *lista, Node *node) {
+    if (!Lista_noNoBloco(lista, node)) {
+        free(node);
+    }
+}
 
 /**
  * @brief Inicializa uma nova lista duplamente ligada.
@@ -17,17 +53,31 @@ void Lista_cria(Lista *lista) {
     lista->first = NULL;
     lista->last = NULL;
     lista->current = NULL;
+    lista->bloco = NULL;
+    lista->nBloco = 0;
+    lista->arquivo = NULL;
+    lista->epoca = 0;
+    lista->snapshots = NULL;
+    lista->removidos = NULL;
+    lista->nVersoes = 0;
     lista->nElementos = 0;
 }
 
 /**
  * @brief Destrói a lista, liberando toda a memória alocada para os nós e os produtos.
+ * No modo arquivo, grava as páginas modificadas e fecha o arquivo.
+ * Snapshots ainda abertos são fechados e passam a ficar vazios.
  * @param lista Ponteiro para a estrutura Lista a ser destruída.
  */
 void Lista_destroi(Lista *lista) {
     if (lista == NULL) {
         return; // Nada para destruir se a lista for nula
     }
+    if (lista->arquivo != NULL) {
+        ListaArquivo_fechar(lista);
+        return;
+    }
+    Snapshot_destruirTodos(lista);
 
     Node *current_node = lista->first;
     Node *next_node;
@@ -36,12 +86,18 @@ void Lista_destroi(Lista *lista) {
         next_node = current_node->next;
         // Se o produto foi alocado dinamicamente dentro do nó, libere-o aqui.
         // No seu caso, Produto é uma struct direta no Node, então não precisa de free(current_node->produto)
-        free(current_node); // Libera a memória do nó
+        if (current_node->versoes != NULL) {
+            Snapshot_liberarVersoes(lista, current_node);
+        }
+        Lista_liberaNo(lista, current_node); // Libera a memória do nó
         current_node = next_node;
     }
+    free(lista->bloco); // Libera o bloco contíguo, se houver
     lista->first = NULL;
     lista->last = NULL;
     lista->current = NULL;
+    lista->bloco = NULL;
+    lista->nBloco = 0;
     lista->nElementos = 0;
 }
 
@@ -68,6 +124,9 @@ bool Lista_inserir(Lista *lista, Produto *data) {
         fprintf(stderr, "Erro: Ponteiro de lista ou dados nulos em Lista_inserir.\n");
         return false;
     }
+    if (lista->arquivo != NULL) {
+        return ListaArquivo_inserir(lista, data);
+    }
 
     // Aloca memória para o novo nó
     Node *newNode = (Node *)malloc(sizeof(Node));
@@ -80,6 +139,7 @@ bool Lista_inserir(Lista *lista, Produto *data) {
     newNode->produto = *data; // Copia a struct Produto diretamente
     newNode->next = NULL;
     newNode->prev = NULL;
+    newNode->versoes = NULL;
 
     if (lista->first == NULL) { // Se a lista estiver vazia
         lista->first = newNode;
@@ -112,6 +172,11 @@ bool Lista_atualizar(Lista *lista, int id_produto, Produto *novos_dados) {
 
     Node *nodeToUpdate = Lista_getNodeById(lista, id_produto);
     if (nodeToUpdate != NULL) {
+        // Guarda o valor atual para os snapshots abertos antes de alterá-lo
+        if (!Snapshot_preservarVersao(lista, nodeToUpdate)) {
+            return false;
+        }
+
         // Atualiza o nome se a string nao estiver vazia (nao for o sentinela)
         if (strlen(novos_dados->nome) > 0) {
             strncpy(nodeToUpdate->produto.nome, novos_dados->nome, sizeof(nodeToUpdate->produto.nome) - 1);
@@ -127,6 +192,11 @@ bool Lista_atualizar(Lista *lista, int id_produto, Produto *novos_dados) {
         if (novos_dados->quantidade != -1) {
             nodeToUpdate->produto.quantidade = novos_dados->quantidade;
         }
+
+        // No modo arquivo, a página alterada precisa ser gravada de volta no disco
+        if (lista->arquivo != NULL) {
+            ListaArquivo_marcarModificado(lista, nodeToUpdate);
+        }
         return true;
     }
     return false; // Produto não encontrado
@@ -143,12 +213,22 @@ bool Lista_remover(Lista *lista, int id_produto) {
         fprintf(stderr, "Erro: Ponteiro de lista nulo em Lista_remover.\n");
         return false;
     }
+    if (lista->arquivo != NULL) {
+        // Remover exigiria deslocar todos os registros seguintes no arquivo
+        fprintf(stderr, "Erro: Lista_remover nao e suportada no modo arquivo.\n");
+        return false;
+    }
 
     Node *nodeToRemove = Lista_getNodeById(lista, id_produto);
     if (nodeToRemove == NULL) {
         return false; // Produto não encontrado
     }
 
+    // Snapshots abertos ainda podem ler o nó: a versão guardada marca a época da remoção
+    if (!Snapshot_preservarVersao(lista, nodeToRemove)) {
+        return false;
+    }
+
     // Se o nó a ser removido é o primeiro
     if (nodeToRemove->prev == NULL) {
         lista->first = nodeToRemove->next;
@@ -174,7 +254,14 @@ bool Lista_remover(Lista *lista, int id_produto) {
         }
     }
 
-    free(nodeToRemove); // Libera a memória do nó
+    if (lista->snapshots != NULL) {
+        // Adia a liberação até que nenhum snapshot aberto contenha o nó
+        nodeToRemove->prev = NULL;
+        nodeToRemove->next = lista->removidos;
+        lista->removidos = nodeToRemove;
+    } else {
+        Lista_liberaNo(lista, nodeToRemove); // Libera a memória do nó
+    }
     lista->nElementos--;
     return true;
 }
@@ -183,8 +270,13 @@ bool Lista_remover(Lista *lista, int id_produto) {
  * @brief Move o ponteiro 'current' para o próximo nó na lista.
  * @param lista Ponteiro para a estrutura Lista.
  * @return true se o 'current' foi movido, false se já estava no final.
+ * No modo arquivo, false também indica falha de leitura; compare as posições
+ * percorridas com Lista_getSize para distinguir os casos.
  */
 bool Lista_next(Lista *lista) {
+    if (lista != NULL && lista->arquivo != NULL) {
+        return lista->current != NULL && ListaArquivo_irPara(lista, lista->arquivo->indiceAtual + 1);
+    }
     if (lista == NULL || lista->current == NULL || lista->current->next == NULL) {
         return false;
     }
@@ -196,8 +288,13 @@ bool Lista_next(Lista *lista) {
  * @brief Move o ponteiro 'current' para o nó anterior na lista.
  * @param lista Ponteiro para a estrutura Lista.
  * @return true se o 'current' foi movido, false se já estava no início.
+ * No modo arquivo, false também indica falha de leitura; compare as posições
+ * percorridas com Lista_getSize para distinguir os casos.
  */
 bool Lista_prev(Lista *lista) {
+    if (lista != NULL && lista->arquivo != NULL) {
+        return lista->current != NULL && ListaArquivo_irPara(lista, lista->arquivo->indiceAtual - 1);
+    }
     if (lista == NULL || lista->current == NULL || lista->current->prev == NULL) {
         return false;
     }
@@ -210,7 +307,9 @@ bool Lista_prev(Lista *lista) {
  * @param lista Ponteiro para a estrutura Lista.
  */
 void Lista_goFirst(Lista *lista) {
-    if (lista != NULL) {
+    if (lista != NULL && lista->arquivo != NULL) {
+        ListaArquivo_irPara(lista, 0);
+    } else if (lista != NULL) {
         lista->current = lista->first;
     }
 }
@@ -220,7 +319,9 @@ void Lista_goFirst(Lista *lista) {
  * @param lista Ponteiro para a estrutura Lista.
  */
 void Lista_goLast(Lista *lista) {
-    if (lista != NULL) {
+    if (lista != NULL && lista->arquivo != NULL) {
+        ListaArquivo_irPara(lista, lista->nElementos - 1);
+    } else if (lista != NULL) {
         lista->current = lista->last;
     }
 }
@@ -242,8 +343,12 @@ Produto *Lista_getCurrent(Lista *lista) {
  * @param lista Ponteiro para a estrutura Lista.
  * @param id_produto O ID do produto a ser buscado.
  * @return Ponteiro para o Nó encontrado, ou NULL se não for encontrado.
+ * No modo arquivo, o ponteiro só é válido até o próximo acesso a outra página.
  */
 Node *Lista_getNodeById(Lista *lista, int id_produto) {
+    if (lista != NULL && lista->arquivo != NULL) {
+        return ListaArquivo_getNodeById(lista, id_produto);
+    }
     if (lista == NULL || lista->first == NULL) {
         return NULL;
     }
@@ -257,3 +362,113 @@ Node *Lista_getNodeById(Lista *lista, int id_produto) {
     }
     return NULL; // Não encontrado
 }
+
+/**
+ * @brief Calcula a distância média, em bytes, entre os endereços de nós vizinhos.
+ * Quanto menor o valor, melhor a localidade de memória ao percorrer a lista.
+ * Em uma lista compactada a distância é exatamente sizeof(Node).
+ * @param lista Ponteiro para a estrutura Lista.
+ * @return A distância média entre vizinhos, ou 0 se a lista tiver menos de dois nós.
+ */
+double Lista_distanciaMedia(Lista *lista) {
+    if (lista == NULL || lista->first == NULL || lista->first->next == NULL) {
+        return 0.0;
+    }
+
+    double soma = 0.0;
+    int pares = 0;
+    Node *temp = lista->first;
+    while (temp->next != NULL) {
+        uintptr_t a = (uintptr_t)temp;
+        uintptr_t b = (uintptr_t)temp->next;
+        soma += (double)(a > b ? a - b : b - a);
+        pares++;
+        temp = temp->next;
+    }
+    return soma / pares;
+}
+
+/**
+ * @brief Realoca todos os nós em um único bloco contíguo, na ordem da lista.
+ * Os ponteiros prev/next/first/last/current são ajustados para o novo bloco,
+ * os nós antigos são liberados e a memória livre é devolvida ao sistema
+ * (quando suportado pela libc). Ponteiros para nós obtidos antes da
+ * compactação (ex: via Lista_getNodeById) deixam de ser válidos.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param distancia_antes Se não for NULL, recebe a distância média entre vizinhos antes da compactação.
+ * @param distancia_depois Se não for NULL, recebe a distância média entre vizinhos depois da compactação.
+ * @return true se a compactação foi bem-sucedida, false caso contrário.
+ */
+bool Lista_compactar(Lista *lista, double *distancia_antes, double *distancia_depois) {
+    if (lista == NULL) {
+        fprintf(stderr, "Erro: Ponteiro de lista nulo em Lista_compactar.\n");
+        return false;
+    }
+    if (lista->arquivo != NULL) {
+        // As páginas do modo arquivo já são contíguas
+        fprintf(stderr, "Erro: Lista_compactar nao se aplica ao modo arquivo.\n");
+        return false;
+    }
+    if (lista->snapshots != NULL) {
+        // Os snapshots abertos guardam os endereços atuais dos nós
+        fprintf(stderr, "Erro: Lista_compactar nao pode ser usada com snapshots abertos.\n");
+        return false;
+    }
+
+    double antes = Lista_distanciaMedia(lista);
+    if (distancia_antes != NULL) {
+        *distancia_antes = antes;
+    }
+
+    if (lista->nElementos == 0) {
+        // Nada a realocar, apenas descarta o bloco antigo (vazio)
+        free(lista->bloco);
+        lista->bloco = NULL;
+        lista->nBloco = 0;
+        if (distancia_depois != NULL) {
+            *distancia_depois = 0.0;
+        }
+        return true;
+    }
+
+    // Aloca o novo bloco antes de liberar qualquer coisa, para não perder dados em caso de falha
+    Node *novoBloco = (Node *)malloc((size_t)lista->nElementos * sizeof(Node));
+    if (novoBloco == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o bloco compactado.\n");
+        return false;
+    }
+
+    // Copia os produtos na ordem da lista, liberando os nós antigos
+    Node *temp = lista->first;
+    Node *novoCurrent = NULL;
+    int i = 0;
+    while (temp != NULL) {
+        Node *proximo = temp->next;
+        novoBloco[i].produto = temp->produto;
+        novoBloco[i].prev = (i > 0) ? &novoBloco[i - 1] : NULL;
+        novoBloco[i].next = (proximo != NULL) ? &novoBloco[i + 1] : NULL;
+        novoBloco[i].versoes = NULL; // Sem snapshots abertos não há versões antigas
+        if (temp == lista->current) {
+            novoCurrent = &novoBloco[i];
+        }
+        Lista_liberaNo(lista, temp);
+        temp = proximo;
+        i++;
+    }
+    free(lista->bloco); // O bloco antigo (se houver) já não é referenciado
+
+    lista->bloco = novoBloco;
+    lista->nBloco = lista->nElementos;
+    lista->first = &novoBloco[0];
+    lista->last = &novoBloco[lista->nElementos - 1];
+    lista->current = novoCurrent;
+
+#ifdef __GLIBC__
+    malloc_trim(0); // Devolve ao sistema as páginas livres no topo e no meio do heap
+#endif
+
+    if (distancia_depois != NULL) {
+        *distancia_depois = Lista_distanciaMedia(lista);
+    }
+    return true;
+}
@@ -4,10 +4,12 @@
 #include <string.h>  // Para strncpy, strcspn
 #include <stdbool.h> // Para tipo bool
 #include <termios.h> // Para controle do terminal (tcgetattr, tcsetattr)
-#include <unistd.h>  // Para STDIN_FILENO, read
+#include <unistd.h>  // Para STDIN_FILENO, read, access
 
 #include "lista_dupla.h" // Inclui as definições da lista e do produto
 #include "produto.h"      // Inclui funções de criação de produto
+#include "lista_arquivo.h" // Inclui o modo arquivo (catálogo carregado sob demanda)
+#include "exportador.h"    // Inclui a exportação para CSV, JSON Lines e binário
 
 // --- Variáveis Globais para o Terminal ---
 // Armazenam as configurações originais do terminal para restaurá-las ao sair.
@@ -122,7 +124,9 @@ void display_menu(int selected_option) {
         "6. Exibir Todos os Produtos (Tras)",
         "7. Navegar na Lista (Atual)",
         "8. Tamanho da Lista",
-        "9. Sair"
+        "9. Compactar Lista (Localidade de Memoria)",
+        "10. Exportar Lista (CSV/JSON Lines/Binario)",
+        "11. Sair"
     };
     int num_options = sizeof(options) / sizeof(options[0]);
 
@@ -210,25 +214,73 @@ void get_updated_product_data_input(Produto *p) {
     set_raw_mode();
 }
 
+/**
+ * @brief Solicita e lê o formato e o caminho do arquivo de exportação.
+ * @param formato Ponteiro onde o formato escolhido sera armazenado.
+ * @param caminho Buffer onde o caminho do arquivo sera armazenado.
+ * @param tam_caminho Tamanho do buffer 'caminho'.
+ * @return true se o formato informado for valido, false caso contrario.
+ */
+bool get_export_input(FormatoExportacao *formato, char *caminho, int tam_caminho) {
+    char nome_formato[16];
+    // Temporariamente desabilita o modo raw para permitir entrada normal com buffer
+    reset_terminal_mode();
+
+    printf("Formato (csv, jsonl ou bin): ");
+    fgets(nome_formato, sizeof(nome_formato), stdin);
+    nome_formato[strcspn(nome_formato, "\n")] = 0; // Remove o caractere de nova linha
+
+    printf("Arquivo de destino: ");
+    fgets(caminho, tam_caminho, stdin);
+    caminho[strcspn(caminho, "\n")] = 0; // Remove o caractere de nova linha
+
+    // Restaura o modo raw
+    set_raw_mode();
+    return Exportador_formatoPorNome(nome_formato, formato);
+}
 
 // --- Função Principal ---
 
-int main() {
+int main(int argc, char *argv[]) {
     Lista minhaLista;
     Lista_cria(&minhaLista);
 
-    // Adiciona alguns produtos de exemplo para iniciar
-    Produto p1 = criarProduto(101, "Teclado Mecanico", 350.00, 15);
-    Lista_inserir(&minhaLista, &p1);
-    Produto p2 = criarProduto(102, "Mouse Gamer RGB", 120.50, 30);
-    Lista_inserir(&minhaLista, &p2);
-    Produto p3 = criarProduto(103, "Monitor Ultrawide", 1800.00, 8);
-    Lista_inserir(&minhaLista, &p3);
+    if (argc > 1) {
+        // Ao apenas exportar, um caminho digitado errado não deve virar um catálogo vazio novo
+        if (argc > 2 && access(argv[1], F_OK) != 0) {
+            fprintf(stderr, "Erro: O catalogo '%s' nao existe.\n", argv[1]);
+            return 1;
+        }
+        // Usa o catálogo em disco informado, carregando os produtos sob demanda
+        if (!Lista_abrirArquivo(&minhaLista, argv[1], ORCAMENTO_PADRAO_BYTES)) {
+            return 1;
+        }
+        // Com um formato como segundo argumento, exporta o catálogo para a saída padrão e encerra
+        if (argc > 2) {
+            FormatoExportacao formato;
+            if (!Exportador_formatoPorNome(argv[2], &formato)) {
+                fprintf(stderr, "Erro: Formato '%s' invalido (use csv, jsonl ou bin).\n", argv[2]);
+                Lista_destroi(&minhaLista);
+                return 1;
+            }
+            long exportados = Lista_exportar(&minhaLista, STDOUT_FILENO, formato, NULL, NULL);
+            Lista_destroi(&minhaLista);
+            return exportados < 0 ? 1 : 0;
+        }
+    } else {
+        // Adiciona alguns produtos de exemplo para iniciar
+        Produto p1 = criarProduto(101, "Teclado Mecanico", 350.00, 15);
+        Lista_inserir(&minhaLista, &p1);
+        Produto p2 = criarProduto(102, "Mouse Gamer RGB", 120.50, 30);
+        Lista_inserir(&minhaLista, &p2);
+        Produto p3 = criarProduto(103, "Monitor Ultrawide", 1800.00, 8);
+        Lista_inserir(&minhaLista, &p3);
+    }
 
     int selected_option = 1; // Opção inicial selecionada no menu
     int key;
     bool running = true;
-    const int num_menu_options = 9; // Total de opções no menu
+    const int num_menu_options = 11; // Total de opções no menu
 
     // Configura o terminal para o modo raw ao iniciar o programa
     set_raw_mode();
@@ -301,13 +353,27 @@ int main() {
                         set_color(ANSI_COLOR_GREEN); printf("--- Produtos na Lista (Frente) ---\n"); reset_color();
                         if (Lista_getSize(&minhaLista) == 0) {
                             set_color(ANSI_COLOR_YELLOW); printf("A lista esta vazia.\n"); reset_color();
-                        } else {
+                        } else if (minhaLista.arquivo == NULL) {
                             // Iteração segura usando um nó temporário para evitar loop infinito
                             Node *temp = minhaLista.first;
                             while (temp != NULL) {
                                 exibir_detalhes_produto(&(temp->produto));
                                 temp = temp->next;
                             }
+                        } else {
+                            // No modo arquivo os nós são carregados sob demanda: percorre pelo cursor
+                            Lista_goFirst(&minhaLista);
+                            int exibidos = 0;
+                            Produto *current_p = Lista_getCurrent(&minhaLista);
+                            while (current_p != NULL) {
+                                exibir_detalhes_produto(current_p);
+                                exibidos++;
+                                current_p = Lista_next(&minhaLista) ? Lista_getCurrent(&minhaLista) : NULL;
+                            }
+                            // No modo arquivo, uma falha de leitura também interrompe o cursor
+                            if (exibidos < Lista_getSize(&minhaLista)) {
+                                set_color(ANSI_COLOR_RED); printf("Erro ao ler a lista: %d de %d produtos exibidos.\n", exibidos, Lista_getSize(&minhaLista)); reset_color();
+                            }
                         }
                         break;
                     }
@@ -315,13 +381,27 @@ int main() {
                         set_color(ANSI_COLOR_GREEN); printf("--- Produtos na Lista (Tras) ---\n"); reset_color();
                         if (Lista_getSize(&minhaLista) == 0) {
                             set_color(ANSI_COLOR_YELLOW); printf("A lista esta vazia.\n"); reset_color();
-                        } else {
+                        } else if (minhaLista.arquivo == NULL) {
                             // Iteração segura usando um nó temporário para evitar loop infinito
                             Node *temp = minhaLista.last;
                             while (temp != NULL) {
                                 exibir_detalhes_produto(&(temp->produto));
                                 temp = temp->prev;
                             }
+                        } else {
+                            // No modo arquivo os nós são carregados sob demanda: percorre pelo cursor
+                            Lista_goLast(&minhaLista);
+                            int exibidos = 0;
+                            Produto *current_p = Lista_getCurrent(&minhaLista);
+                            while (current_p != NULL) {
+                                exibir_detalhes_produto(current_p);
+                                exibidos++;
+                                current_p = Lista_prev(&minhaLista) ? Lista_getCurrent(&minhaLista) : NULL;
+                            }
+                            // No modo arquivo, uma falha de leitura também interrompe o cursor
+                            if (exibidos < Lista_getSize(&minhaLista)) {
+                                set_color(ANSI_COLOR_RED); printf("Erro ao ler a lista: %d de %d produtos exibidos.\n", exibidos, Lista_getSize(&minhaLista)); reset_color();
+                            }
                         }
                         break;
                     }
@@ -361,7 +441,34 @@ int main() {
                         printf("A lista contem %d produtos.\n", Lista_getSize(&minhaLista));
                         break;
                     }
-                    case 9: // Sair do programa
+                    case 9: { // Compactar Lista
+                        set_color(ANSI_COLOR_GREEN); printf("--- Compactar Lista ---\n"); reset_color();
+                        double antes, depois;
+                        if (Lista_compactar(&minhaLista, &antes, &depois)) {
+                            set_color(ANSI_COLOR_GREEN); printf("Lista compactada com sucesso!\n"); reset_color();
+                            printf("Distancia media entre vizinhos: %.1f bytes -> %.1f bytes\n", antes, depois);
+                        } else {
+                            set_color(ANSI_COLOR_RED); printf("Falha ao compactar a lista.\n"); reset_color();
+                        }
+                        break;
+                    }
+                    case 10: { // Exportar Lista
+                        set_color(ANSI_COLOR_GREEN); printf("--- Exportar Lista ---\n"); reset_color();
+                        FormatoExportacao formato;
+                        char caminho[256];
+                        if (!get_export_input(&formato, caminho, sizeof(caminho))) {
+                            set_color(ANSI_COLOR_RED); printf("Formato invalido.\n"); reset_color();
+                            break;
+                        }
+                        long exportados = Lista_exportarArquivo(&minhaLista, caminho, formato, NULL, NULL);
+                        if (exportados >= 0) {
+                            set_color(ANSI_COLOR_GREEN); printf("%ld produtos exportados para '%s'.\n", exportados, caminho); reset_color();
+                        } else {
+                            set_color(ANSI_COLOR_RED); printf("Falha ao exportar a lista.\n"); reset_color();
+                        }
+                        break;
+                    }
+                    case 11: // Sair do programa
                         running = false;
                         set_color(ANSI_COLOR_BLUE); printf("Saindo do programa. Ate mais!\n"); reset_color();
                         break;
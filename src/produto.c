@@ -1,5 +1,5 @@
 #include "produto.h"
-#include <string.h> // Para strncpy
+#include <string.h> // Para strncpy, memset
 #include <stdio.h>  // Para printf (se houvesse funções de exibição aqui)
 
 /**
@@ -35,3 +35,17 @@ void exibir_detalhes_produto(Produto *p) {
            p->id, p->nome, p->preco, p->quantidade);
 }
 
+
+/**
+ * @brief Copia um produto como registro de tamanho fixo, com bytes de preenchimento zerados.
+ * @param destino Registro a ser preenchido.
+ * @param origem Produto a ser copiado.
+ */
+void copiarRegistroProduto(Produto *destino, const Produto *origem) {
+    memset(destino, 0, sizeof(*destino)); // Zera o preenchimento entre os campos
+    destino->id = origem->id;
+    // strncpy completa com zeros o restante do nome após o terminador
+    strncpy(destino->nome, origem->nome, sizeof(destino->nome) - 1);
+    destino->preco = origem->preco;
+    destino->quantidade = origem->quantidade;
+}
@@ -0,0 +1,285 @@
+// src/snapshot.c
+#include <stdio.h>   // Para fprintf
+#include <stdlib.h>  // Para malloc, free
+#include <limits.h>  // Para ULONG_MAX
+#include <stdbool.h> // Para tipo bool
+#include "snapshot.h" // Inclui as definições de snapshot e versões
+#include "lista_interna.h" // Funções compartilhadas entre os módulos da lista
+
+/**
+ * @brief Libera as versões de um nó que nenhum snapshot com época >= 'epoca_minima' pode ver.
+ * Como as versões estão em ordem decrescente de época, basta cortar a lista no
+ * primeiro elemento com época menor que 'epoca_minima'.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param node Ponteiro para o nó cujas versões serão podadas.
+ * @param epoca_minima Menor época entre os snapshots abertos (ULONG_MAX se não houver nenhum).
+ */
+static void Snapshot_podarVersoes(Lista *lista, Node *node, unsigned long epoca_minima) {
+    VersaoProduto **ref = &node->versoes;
+    while (*ref != NULL && (*ref)->epoca >= epoca_minima) {
+        ref = &(*ref)->anterior;
+    }
+
+    VersaoProduto *versao = *ref;
+    *ref = NULL;
+    while (versao != NULL) {
+        VersaoProduto *anterior = versao->anterior;
+        free(versao);
+        lista->nVersoes--;
+        versao = anterior;
+    }
+}
+
+/**
+ * @brief Coleta versões e nós removidos que nenhum snapshot aberto ainda pode ver.
+ * @param lista Ponteiro para a estrutura Lista.
+ */
+static void Snapshot_coletar(Lista *lista) {
+    if (lista->nVersoes == 0) {
+        return; // Nenhuma versão antiga (e, portanto, nenhum nó removido pendente)
+    }
+
+    unsigned long epocaMinima = ULONG_MAX;
+    for (Snapshot *s = lista->snapshots; s != NULL; s = s->proximo) {
+        if (s->epoca < epocaMinima) {
+            epocaMinima = s->epoca;
+        }
+    }
+
+    for (Node *temp = lista->first; temp != NULL; temp = temp->next) {
+        if (temp->versoes != NULL) {
+            Snapshot_podarVersoes(lista, temp, epocaMinima);
+        }
+    }
+
+    // A versão mais nova de um nó removido tem a época da remoção: se ela
+    // é anterior a todos os snapshots abertos, nenhum deles contém o nó
+    Node **ref = &lista->removidos;
+    while (*ref != NULL) {
+        Node *removido = *ref;
+        if (removido->versoes->epoca < epocaMinima) {
+            *ref = removido->next;
+            Snapshot_liberarVersoes(lista, removido);
+            Lista_liberaNo(lista, removido);
+        } else {
+            Snapshot_podarVersoes(lista, removido, epocaMinima);
+            ref = &removido->next;
+        }
+    }
+}
+
+/**
+ * @brief Abre um snapshot: uma visão da lista congelada neste instante.
+ * Alterações e remoções feitas depois com Lista_atualizar/Lista_remover não são vistas
+ * pelo snapshot, que também nunca acessa nós já liberados. Inserções posteriores ficam de fora.
+ * Custa um ponteiro por produto; os valores antigos só são copiados quando alterados.
+ * Não é suportado no modo arquivo.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param snapshot Ponteiro para a estrutura Snapshot a ser inicializada.
+ * @return true se o snapshot foi aberto, false caso contrário.
+ */
+bool Lista_abrirSnapshot(Lista *lista, Snapshot *snapshot) {
+    if (lista == NULL || snapshot == NULL) {
+        fprintf(stderr, "Erro: Ponteiro de lista ou snapshot nulos em Lista_abrirSnapshot.\n");
+        return false;
+    }
+    if (lista->arquivo != NULL) {
+        // No modo arquivo os nós mudam de endereço quando suas páginas saem do cache
+        fprintf(stderr, "Erro: Lista_abrirSnapshot nao e suportada no modo arquivo.\n");
+        return false;
+    }
+
+    snapshot->nos = NULL;
+    if (lista->nElementos > 0) {
+        snapshot->nos = (Node **)malloc((size_t)lista->nElementos * sizeof(Node *));
+        if (snapshot->nos == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação de memória para o snapshot.\n");
+            return false;
+        }
+    }
+
+    int i = 0;
+    for (Node *temp = lista->first; temp != NULL; temp = temp->next) {
+        snapshot->nos[i++] = temp;
+    }
+
+    // Cada snapshot inicia uma nova época; alterações feitas a partir daqui
+    // guardam o valor antigo para os snapshots com época menor ou igual
+    lista->epoca++;
+    snapshot->lista = lista;
+    snapshot->epoca = lista->epoca;
+    snapshot->nElementos = lista->nElementos;
+    snapshot->posicao = (lista->nElementos > 0) ? 0 : -1;
+    snapshot->proximo = lista->snapshots;
+    lista->snapshots = snapshot;
+    return true;
+}
+
+/**
+ * @brief Fecha o snapshot e libera as versões antigas que nenhum outro snapshot aberto usa.
+ * @param snapshot Ponteiro para o snapshot a ser fechado.
+ */
+void Lista_fecharSnapshot(Snapshot *snapshot) {
+    if (snapshot == NULL || snapshot->lista == NULL) {
+        return; // Snapshot nulo ou já fechado
+    }
+
+    Lista *lista = snapshot->lista;
+    Snapshot **ref = &lista->snapshots;
+    while (*ref != NULL && *ref != snapshot) {
+        ref = &(*ref)->proximo;
+    }
+    if (*ref != NULL) {
+        *ref = snapshot->proximo;
+    }
+
+    free(snapshot->nos);
+    snapshot->nos = NULL;
+    snapshot->lista = NULL;
+    snapshot->nElementos = 0;
+    snapshot->posicao = -1;
+    Snapshot_coletar(lista);
+}
+
+/**
+ * @brief Retorna o número de produtos no snapshot.
+ * @param snapshot Ponteiro para o snapshot.
+ * @return O número de produtos no momento da abertura.
+ */
+int Snapshot_getSize(Snapshot *snapshot) {
+    if (snapshot == NULL) {
+        return 0;
+    }
+    return snapshot->nElementos;
+}
+
+/**
+ * @brief Move o cursor do snapshot para o próximo produto.
+ * @param snapshot Ponteiro para o snapshot.
+ * @return true se o cursor foi movido, false se já estava no final.
+ */
+bool Snapshot_next(Snapshot *snapshot) {
+    if (snapshot == NULL || snapshot->posicao < 0 || snapshot->posicao + 1 >= snapshot->nElementos) {
+        return false;
+    }
+    snapshot->posicao++;
+    return true;
+}
+
+/**
+ * @brief Move o cursor do snapshot para o produto anterior.
+ * @param snapshot Ponteiro para o snapshot.
+ * @return true se o cursor foi movido, false se já estava no início.
+ */
+bool Snapshot_prev(Snapshot *snapshot) {
+    if (snapshot == NULL || snapshot->posicao <= 0) {
+        return false;
+    }
+    snapshot->posicao--;
+    return true;
+}
+
+/**
+ * @brief Move o cursor do snapshot para o primeiro produto.
+ * @param snapshot Ponteiro para o snapshot.
+ */
+void Snapshot_goFirst(Snapshot *snapshot) {
+    if (snapshot != NULL) {
+        snapshot->posicao = (snapshot->nElementos > 0) ? 0 : -1;
+    }
+}
+
+/**
+ * @brief Move o cursor do snapshot para o último produto.
+ * @param snapshot Ponteiro para o snapshot.
+ */
+void Snapshot_goLast(Snapshot *snapshot) {
+    if (snapshot != NULL) {
+        snapshot->posicao = snapshot->nElementos - 1;
+    }
+}
+
+/**
+ * @brief Retorna o produto sob o cursor, como ele estava na abertura do snapshot.
+ * Se o produto ainda não foi alterado, o ponteiro aponta para o nó da lista: ele só é
+ * válido até o próximo Lista_atualizar/Lista_remover. Copie o Produto para mantê-lo.
+ * @param snapshot Ponteiro para o snapshot.
+ * @return Ponteiro para o Produto (somente leitura), ou NULL se o snapshot estiver vazio ou fechado.
+ */
+const Produto *Snapshot_getCurrent(Snapshot *snapshot) {
+    if (snapshot == NULL || snapshot->lista == NULL || snapshot->posicao < 0) {
+        return NULL;
+    }
+
+    // A versão certa é a mais antiga com época >= a do snapshot; sem nenhuma, vale o valor atual
+    Node *node = snapshot->nos[snapshot->posicao];
+    const Produto *produto = &node->produto;
+    for (VersaoProduto *v = node->versoes; v != NULL && v->epoca >= snapshot->epoca; v = v->anterior) {
+        produto = &v->produto;
+    }
+    return produto;
+}
+
+/**
+ * @brief Guarda o valor atual do nó antes de uma alteração, se algum snapshot aberto puder vê-lo.
+ * Só uma versão é guardada por época: alterações repetidas entre duas aberturas de
+ * snapshot não geram cópias extras.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param node Ponteiro para o nó que será alterado ou removido.
+ * @return true se o valor foi guardado (ou não era necessário), false em caso de falha de memória.
+ */
+bool Snapshot_preservarVersao(Lista *lista, Node *node) {
+    if (lista->snapshots == NULL) {
+        return true; // Ninguém pode ver o valor antigo
+    }
+    if (node->versoes != NULL && node->versoes->epoca == lista->epoca) {
+        return true; // O valor visível aos snapshots abertos já foi guardado
+    }
+
+    VersaoProduto *versao = (VersaoProduto *)malloc(sizeof(VersaoProduto));
+    if (versao == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a versao do produto.\n");
+        return false;
+    }
+    versao->produto = node->produto;
+    versao->epoca = lista->epoca;
+    versao->anterior = node->versoes;
+    node->versoes = versao;
+    lista->nVersoes++;
+    return true;
+}
+
+/**
+ * @brief Libera todas as versões antigas de um nó.
+ * @param lista Ponteiro para a estrutura Lista.
+ * @param node Ponteiro para o nó.
+ */
+void Snapshot_liberarVersoes(Lista *lista, Node *node) {
+    Snapshot_podarVersoes(lista, node, ULONG_MAX);
+}
+
+/**
+ * @brief Fecha todos os snapshots da lista e libera os nós removidos pendentes.
+ * Chamada por Lista_destroi; snapshots ainda abertos passam a ficar vazios.
+ * @param lista Ponteiro para a estrutura Lista.
+ */
+void Snapshot_destruirTodos(Lista *lista) {
+    Snapshot *snapshot = lista->snapshots;
+    while (snapshot != NULL) {
+        Snapshot *proximo = snapshot->proximo;
+        free(snapshot->nos);
+        snapshot->nos = NULL;
+        snapshot->lista = NULL;
+        snapshot->nElementos = 0;
+        snapshot->posicao = -1;
+        snapshot = proximo;
+    }
+    lista->snapshots = NULL;
+
+    while (lista->removidos != NULL) {
+        Node *removido = lista->removidos;
+        lista->removidos = removido->next;
+        Snapshot_liberarVersoes(lista, removido);
+        Lista_liberaNo(lista, removido);
+    }
+}